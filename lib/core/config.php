@@ -84,6 +84,7 @@ function prepareConfig($config) {
     normalizeBoolean($config, 'issueCheckSequences', true);
     normalizeBoolean($config, 'efuseMonitorEnabled', false);
     normalizeBoolean($config, 'voltageMonitorEnabled', false);
+    normalizeBoolean($config, 'clockProbeEnabled', false);
 
     // Parse retention days as integer
     if (isset($config['mqttRetentionDays'])) {
@@ -106,6 +107,13 @@ function prepareConfig($config) {
         $config['efuseRetentionDays'] = WATCHERDEFAULTSETTINGS['efuseRetentionDays'];
     }
 
+    // Parse clock probe interval (1-60 seconds)
+    if (isset($config['clockProbeInterval'])) {
+        $config['clockProbeInterval'] = max(1, min(60, intval($config['clockProbeInterval'])));
+    } else {
+        $config['clockProbeInterval'] = WATCHERDEFAULTSETTINGS['clockProbeInterval'];
+    }
+
     // Parse voltage collection interval (1-10 seconds)
     if (isset($config['voltageCollectionInterval'])) {
         $config['voltageCollectionInterval'] = max(1, min(10, intval($config['voltageCollectionInterval'])));
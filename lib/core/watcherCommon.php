@@ -66,6 +66,10 @@ define("WATCHERDEFAULTSETTINGS",
         'multiSyncMetricsEnabled' => false,
         'multiSyncPingEnabled' => false,
         'multiSyncPingInterval' => 60,
+        'clockProbeEnabled' => false,      // UDP clock offset probe (C++ plugin)
+        'clockProbeInterval' => 2,         // seconds between UDP clock probes (1-60)
+        'clockProbePort' => 32329,         // UDP port for clock probes
+        'clockProbeTargets' => '',         // extra numeric ip[:port] probe targets
         'falconMonitorEnabled' => false,
         'controlUIEnabled' => true,
         'mqttMonitorEnabled' => false,
@@ -94,6 +98,10 @@ define("WATCHERSETTINGSRESTARTREQUIRED",
         'multiSyncMetricsEnabled' => false,   // UI visibility only
         'multiSyncPingEnabled' => false,      // Hot-reloadable
         'multiSyncPingInterval' => false,     // Hot-reloadable
+        'clockProbeEnabled' => true,          // Read by C++ plugin at fppd start
+        'clockProbeInterval' => true,         // Read by C++ plugin at fppd start
+        'clockProbePort' => true,             // Read by C++ plugin at fppd start
+        'clockProbeTargets' => true,          // Read by C++ plugin at fppd start
         'falconMonitorEnabled' => false,      // UI visibility only
         'controlUIEnabled' => false,          // UI visibility only
         'mqttMonitorEnabled' => true,         // MQTT subscriber started/stopped
@@ -0,0 +1,67 @@
+/*
+ * WatcherClockMath.h - Pure NTP-style offset math and clock filter
+ *
+ * Kept free of FPP and socket dependencies so it can be unit tested
+ * standalone (see tests/cpp).
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+struct ClockSample {
+    double offsetUs = 0.0;       // Remote minus local, same sign as ClockDrift.php
+    double rttUs = 0.0;          // Round trip excluding the remote's hold time
+    int64_t atMonoUs = 0;        // Local monotonic time the sample was taken
+};
+
+// Four-timestamp exchange. t1/t2/t3 are realtime; the client's send and
+// receive times are monotonic so a realtime step cannot corrupt the RTT.
+// t4 is derived as t1 plus the monotonic elapsed time.
+inline bool ComputeClockSample(int64_t t1, int64_t sentMonoUs, int64_t t2, int64_t t3,
+                               int64_t recvMonoUs, ClockSample& sample) {
+    int64_t elapsedUs = recvMonoUs - sentMonoUs;
+    int64_t holdUs = t3 - t2;
+    if (elapsedUs < 0 || holdUs < 0 || holdUs > elapsedUs) {
+        return false;
+    }
+    int64_t t4 = t1 + elapsedUs;
+
+    sample.rttUs = (double)(elapsedUs - holdUs);
+    sample.offsetUs = ((double)(t2 - t1) + (double)(t3 - t4)) / 2.0;
+    sample.atMonoUs = recvMonoUs;
+    return true;
+}
+
+// Accept only answers to probes actually sent, each at most once and in order
+inline bool IsExpectedSequence(uint32_t seq, uint32_t lastAcceptedSeq, uint32_t nextSeq) {
+    return seq > lastAcceptedSeq && seq < nextSeq;
+}
+
+// Clock filter: the lowest-RTT sample has the least queueing asymmetry.
+// Returns samples.size() when empty.
+inline size_t SelectMinRttSample(const std::deque<ClockSample>& samples) {
+    size_t best = samples.size();
+    for (size_t i = 0; i < samples.size(); i++) {
+        if (best == samples.size() || samples[i].rttUs < samples[best].rttUs) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+// NTP-style jitter: RMS of the other offsets relative to the selected one
+inline double ClockFilterJitterUs(const std::deque<ClockSample>& samples, size_t best) {
+    if (samples.size() < 2 || best >= samples.size()) {
+        return 0.0;
+    }
+    double sumSq = 0.0;
+    for (const auto& s : samples) {
+        double d = s.offsetUs - samples[best].offsetUs;
+        sumSq += d * d;
+    }
+    return std::sqrt(sumSq / (samples.size() - 1));
+}
@@ -0,0 +1,367 @@
+/*
+ * WatcherClockProbe.cpp - NTP-style UDP clock offset probe for FPP Watcher
+ *
+ * Wire format (48 bytes, network byte order):
+ *   0  magic "WCLK"        4  version        5  type (request/response)
+ *   8  sequence           16  t1 client realtime send (us)
+ *  24  client monotonic send (us, echoed)  32  t2 server realtime receive (us)
+ *  40  t3 server realtime transmit (us)
+ *
+ * The server derives t3 from t2 plus its monotonic hold time and the client
+ * derives t4 from t1 plus its monotonic round trip, so a realtime clock step
+ * during an exchange cannot corrupt the RTT.
+ */
+
+#include "fpp-pch.h"
+
+#include "WatcherClockProbe.h"
+
+#include <algorithm>
+#include <cstring>
+#include <endian.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include "log.h"
+
+static const uint8_t PROBE_MAGIC[4] = { 'W', 'C', 'L', 'K' };
+static const uint8_t PROBE_VERSION = 1;
+static const uint8_t PROBE_TYPE_REQUEST = 1;
+static const uint8_t PROBE_TYPE_RESPONSE = 2;
+static const size_t PROBE_PACKET_SIZE = 48;
+
+static const int TARGET_REFRESH_SECONDS = 30;    // Re-read multi-sync remotes this often
+static const int POLL_TIMEOUT_MS = 250;          // Upper bound on shutdown latency
+
+static int64_t RealtimeUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+static int64_t MonotonicUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void PutInt64(uint8_t* p, int64_t v) {
+    uint64_t be = htobe64((uint64_t)v);
+    memcpy(p, &be, sizeof(be));
+}
+
+static int64_t GetInt64(const uint8_t* p) {
+    uint64_t be;
+    memcpy(&be, p, sizeof(be));
+    return (int64_t)be64toh(be);
+}
+
+static void PutUInt32(uint8_t* p, uint32_t v) {
+    uint32_t be = htonl(v);
+    memcpy(p, &be, sizeof(be));
+}
+
+static uint32_t GetUInt32(const uint8_t* p) {
+    uint32_t be;
+    memcpy(&be, p, sizeof(be));
+    return ntohl(be);
+}
+
+WatcherClockProbe::WatcherClockProbe(int port, int intervalMs, TargetProvider targetProvider)
+    : m_port(port),
+      m_intervalMs(intervalMs),
+      m_targetProvider(targetProvider)
+{
+}
+
+WatcherClockProbe::~WatcherClockProbe() {
+    Stop();
+}
+
+bool WatcherClockProbe::Start() {
+    if (m_running) return true;
+
+    m_socket = socket(AF_INET, SOCK_DGRAM, 0);
+    if (m_socket < 0) {
+        LogErr(VB_PLUGIN, "WatcherClockProbe: Unable to create socket: %s\n", strerror(errno));
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_error = std::string("socket failed: ") + strerror(errno);
+        return false;
+    }
+
+    // No SO_REUSEADDR: a second instance on the same port must fail here
+    // rather than silently share (and steal) this instance's datagrams
+
+    sockaddr_in bindAddr;
+    memset(&bindAddr, 0, sizeof(bindAddr));
+    bindAddr.sin_family = AF_INET;
+    bindAddr.sin_addr.s_addr = htonl(INADDR_ANY);
+    bindAddr.sin_port = htons(m_port);
+
+    if (bind(m_socket, (sockaddr*)&bindAddr, sizeof(bindAddr)) < 0) {
+        LogErr(VB_PLUGIN, "WatcherClockProbe: Unable to bind UDP port %d: %s\n", m_port, strerror(errno));
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_error = "bind failed on port " + std::to_string(m_port) + ": " + strerror(errno);
+        close(m_socket);
+        m_socket = -1;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_error.clear();
+    }
+
+    fcntl(m_socket, F_SETFL, fcntl(m_socket, F_GETFL) | O_NONBLOCK);
+
+    m_running = true;
+    m_thread = std::thread(&WatcherClockProbe::Run, this);
+
+    LogInfo(VB_PLUGIN, "WatcherClockProbe: Listening on UDP port %d, probe interval %d ms\n",
+            m_port, m_intervalMs);
+    return true;
+}
+
+void WatcherClockProbe::Stop() {
+    if (!m_running) return;
+
+    m_running = false;
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    if (m_socket >= 0) {
+        close(m_socket);
+        m_socket = -1;
+    }
+}
+
+void WatcherClockProbe::Run() {
+    auto nextProbe = std::chrono::steady_clock::now();
+    auto nextRefresh = nextProbe;
+    uint8_t buf[256];
+
+    while (m_running) {
+        auto now = std::chrono::steady_clock::now();
+        int timeoutMs = POLL_TIMEOUT_MS;
+
+        if (m_intervalMs > 0) {
+            if (now >= nextRefresh) {
+                RefreshTargets();
+                nextRefresh = now + std::chrono::seconds(TARGET_REFRESH_SECONDS);
+            }
+            if (now >= nextProbe) {
+                SendProbes();
+                nextProbe += std::chrono::milliseconds(m_intervalMs);
+                // Don't burst to catch up after a stall
+                if (nextProbe < now) {
+                    nextProbe = now + std::chrono::milliseconds(m_intervalMs);
+                }
+            }
+            auto untilProbe = std::chrono::duration_cast<std::chrono::milliseconds>(
+                nextProbe - std::chrono::steady_clock::now()).count();
+            timeoutMs = (int)std::max<int64_t>(0, std::min<int64_t>(timeoutMs, untilProbe));
+        }
+
+        pollfd pfd = { m_socket, POLLIN, 0 };
+        if (poll(&pfd, 1, timeoutMs) <= 0 || !(pfd.revents & POLLIN)) {
+            continue;
+        }
+
+        // Drain everything queued; timestamp each datagram as soon as it is read
+        while (true) {
+            sockaddr_in from;
+            socklen_t fromLen = sizeof(from);
+            ssize_t len = recvfrom(m_socket, buf, sizeof(buf), 0, (sockaddr*)&from, &fromLen);
+            if (len < 0) break;
+            int64_t recvMonoUs = MonotonicUs();
+            int64_t recvRealUs = RealtimeUs();
+            HandlePacket(buf, (size_t)len, from, recvRealUs, recvMonoUs);
+        }
+    }
+}
+
+void WatcherClockProbe::RefreshTargets() {
+    std::vector<ClockProbeTarget> targets = m_targetProvider ? m_targetProvider()
+                                                             : std::vector<ClockProbeTarget>();
+
+    // Numeric addresses only: this thread also answers other instances' probes,
+    // so a blocking DNS lookup here would skew their t2/t3 timestamps
+    std::map<std::string, Peer> resolved;
+    for (const auto& target : targets) {
+        Peer peer;
+        peer.target = target;
+        memset(&peer.addr, 0, sizeof(peer.addr));
+        peer.addr.sin_family = AF_INET;
+        if (inet_pton(AF_INET, target.address.c_str(), &peer.addr.sin_addr) != 1) {
+            LogDebug(VB_PLUGIN, "WatcherClockProbe: Skipping %s, not a numeric IPv4 address\n",
+                     target.address.c_str());
+            continue;
+        }
+        peer.addr.sin_port = htons(target.port > 0 ? target.port : DEFAULT_PORT);
+
+        resolved.emplace(PeerKey(peer.addr), peer);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Drop peers that disappeared, keep history for the ones that remain
+    for (auto it = m_peers.begin(); it != m_peers.end();) {
+        if (resolved.find(it->first) == resolved.end()) {
+            it = m_peers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto& entry : resolved) {
+        auto it = m_peers.find(entry.first);
+        if (it == m_peers.end()) {
+            m_peers.emplace(entry.first, entry.second);
+        } else {
+            it->second.target = entry.second.target;
+        }
+    }
+}
+
+void WatcherClockProbe::SendProbes() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    uint8_t pkt[PROBE_PACKET_SIZE];
+    for (auto& entry : m_peers) {
+        Peer& peer = entry.second;
+
+        memset(pkt, 0, sizeof(pkt));
+        memcpy(pkt, PROBE_MAGIC, sizeof(PROBE_MAGIC));
+        pkt[4] = PROBE_VERSION;
+        pkt[5] = PROBE_TYPE_REQUEST;
+        PutUInt32(pkt + 8, peer.nextSeq);
+        PutInt64(pkt + 24, MonotonicUs());
+        PutInt64(pkt + 16, RealtimeUs());
+
+        if (sendto(m_socket, pkt, sizeof(pkt), 0, (sockaddr*)&peer.addr, sizeof(peer.addr)) ==
+            (ssize_t)sizeof(pkt)) {
+            peer.nextSeq++;
+            peer.probesSent++;
+        }
+    }
+}
+
+void WatcherClockProbe::HandlePacket(const uint8_t* data, size_t len, const sockaddr_in& from,
+                                     int64_t recvRealUs, int64_t recvMonoUs) {
+    if (len < PROBE_PACKET_SIZE || memcmp(data, PROBE_MAGIC, sizeof(PROBE_MAGIC)) != 0 ||
+        data[4] != PROBE_VERSION) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_invalidPackets++;
+        return;
+    }
+
+    if (data[5] == PROBE_TYPE_REQUEST) {
+        // Echo the request with our receive and transmit timestamps filled in
+        uint8_t pkt[PROBE_PACKET_SIZE];
+        memcpy(pkt, data, sizeof(pkt));
+        pkt[5] = PROBE_TYPE_RESPONSE;
+        PutInt64(pkt + 32, recvRealUs);
+        PutInt64(pkt + 40, recvRealUs + (MonotonicUs() - recvMonoUs));
+        sendto(m_socket, pkt, sizeof(pkt), 0, (const sockaddr*)&from, sizeof(from));
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_requestsServed++;
+        return;
+    }
+
+    if (data[5] != PROBE_TYPE_RESPONSE) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_invalidPackets++;
+        return;
+    }
+
+    uint32_t seq = GetUInt32(data + 8);
+    int64_t t1 = GetInt64(data + 16);
+    int64_t sentMonoUs = GetInt64(data + 24);
+    int64_t t2 = GetInt64(data + 32);
+    int64_t t3 = GetInt64(data + 40);
+
+    std::string key = PeerKey(from);
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_peers.find(key);
+    if (it == m_peers.end()) {
+        // Typically a multi-homed remote replying from a different address than
+        // the one multi-sync advertises
+        LogDebug(VB_PLUGIN, "WatcherClockProbe: Response from unknown peer %s\n", key.c_str());
+        m_invalidPackets++;
+        return;
+    }
+    Peer& peer = it->second;
+
+    ClockSample sample;
+    if (!IsExpectedSequence(seq, peer.lastAcceptedSeq, peer.nextSeq) ||
+        !ComputeClockSample(t1, sentMonoUs, t2, t3, recvMonoUs, sample)) {
+        m_invalidPackets++;
+        return;
+    }
+
+    peer.samples.push_back(sample);
+    while (peer.samples.size() > (size_t)FILTER_SIZE) {
+        peer.samples.pop_front();
+    }
+    peer.lastAcceptedSeq = seq;
+    peer.responsesReceived++;
+    peer.lastResponseMonoUs = recvMonoUs;
+}
+
+std::string WatcherClockProbe::PeerKey(const sockaddr_in& addr) {
+    char ip[INET_ADDRSTRLEN];
+    inet_ntop(AF_INET, &addr.sin_addr, ip, sizeof(ip));
+    return std::string(ip) + ":" + std::to_string(ntohs(addr.sin_port));
+}
+
+Json::Value WatcherClockProbe::GetResults() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Json::Value result;
+    Json::Value hosts(Json::arrayValue);
+
+    int64_t nowMonoUs = MonotonicUs();
+
+    for (const auto& entry : m_peers) {
+        const Peer& peer = entry.second;
+        Json::Value host;
+        host["address"] = peer.target.address;
+        host["hostname"] = peer.target.hostname;
+        host["port"] = (int)ntohs(peer.addr.sin_port);
+        host["probesSent"] = (Json::UInt64)peer.probesSent;
+        host["responsesReceived"] = (Json::UInt64)peer.responsesReceived;
+        host["samples"] = (int)peer.samples.size();
+
+        if (peer.samples.empty()) {
+            host["hasData"] = false;
+            hosts.append(host);
+            continue;
+        }
+
+        size_t best = SelectMinRttSample(peer.samples);
+        const ClockSample& selected = peer.samples[best];
+
+        host["hasData"] = true;
+        host["offsetMs"] = selected.offsetUs / 1000.0;
+        host["rttMs"] = selected.rttUs / 1000.0;
+        host["jitterMs"] = ClockFilterJitterUs(peer.samples, best) / 1000.0;
+        host["sampleAgeMs"] = (Json::Int64)((nowMonoUs - selected.atMonoUs) / 1000);
+        host["lastResponseMs"] = (Json::Int64)((nowMonoUs - peer.lastResponseMonoUs) / 1000);
+        hosts.append(host);
+    }
+
+    result["running"] = m_running.load();
+    if (!m_error.empty()) {
+        result["error"] = m_error;
+    }
+    result["port"] = m_port;
+    result["intervalMs"] = m_intervalMs;
+    result["filterSize"] = FILTER_SIZE;
+    result["requestsServed"] = (Json::UInt64)m_requestsServed;
+    result["invalidPackets"] = (Json::UInt64)m_invalidPackets;
+    result["hosts"] = hosts;
+    result["count"] = hosts.size();
+
+    return result;
+}
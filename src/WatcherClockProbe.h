@@ -0,0 +1,88 @@
+/*
+ * WatcherClockProbe.h - NTP-style UDP clock offset probe for FPP Watcher
+ *
+ * Every Watcher instance answers compact UDP timestamp probes and, when
+ * probing is enabled, periodically probes its multi-sync remotes. Each
+ * exchange carries the four NTP timestamps (t1..t4); the round trip is
+ * measured on the monotonic clock and the offset on the realtime clock.
+ * A min-RTT clock filter over the most recent samples yields the offset
+ * and RTT per remote.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+
+#include <jsoncpp/json/json.h>
+
+#include "WatcherClockMath.h"
+
+// Remote to probe; address must be a numeric IPv4 address, port 0 means the default port
+struct ClockProbeTarget {
+    std::string address;
+    std::string hostname;
+    int port = 0;
+};
+
+class WatcherClockProbe {
+public:
+    static const int DEFAULT_PORT = 32329;       // FPP MultiSync is 32320
+    static const int FILTER_SIZE = 8;            // Samples kept per remote (NTP clock filter size)
+
+    typedef std::function<std::vector<ClockProbeTarget>()> TargetProvider;
+
+    // intervalMs <= 0 answers probes but never sends any. Nothing is bound
+    // until Start(); GetResults() reports "error" until then or on failure.
+    WatcherClockProbe(int port, int intervalMs, TargetProvider targetProvider);
+    ~WatcherClockProbe();
+
+    bool Start();
+    void Stop();
+
+    Json::Value GetResults();
+
+private:
+    struct Peer {
+        ClockProbeTarget target;
+        sockaddr_in addr;
+        uint32_t nextSeq = 1;
+        uint32_t lastAcceptedSeq = 0;
+        uint64_t probesSent = 0;
+        uint64_t responsesReceived = 0;
+        std::deque<ClockSample> samples;
+        int64_t lastResponseMonoUs = 0;
+    };
+
+    void Run();
+    void RefreshTargets();
+    void SendProbes();
+    void HandlePacket(const uint8_t* data, size_t len, const sockaddr_in& from,
+                      int64_t recvRealUs, int64_t recvMonoUs);
+
+    static std::string PeerKey(const sockaddr_in& addr);
+
+    int m_port;
+    int m_intervalMs;
+    TargetProvider m_targetProvider;
+
+    int m_socket = -1;
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::string m_error = "Not started";
+
+    std::mutex m_mutex;
+    std::map<std::string, Peer> m_peers;         // Keyed by "ip:port"
+    uint64_t m_requestsServed = 0;
+    uint64_t m_invalidPackets = 0;
+};
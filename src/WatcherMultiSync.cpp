@@ -11,7 +11,9 @@
 #include <chrono>
 #include <cmath>
 #include <fstream>
+#include <memory>
 #include <mutex>
+#include <sstream>
 #include <string>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -28,9 +30,13 @@
 #include "common.h"
 #include "settings.h"
 
+#include "WatcherClockProbe.h"
+
 // Configuration constants
 static const int STALE_HOST_SECONDS = 30;        // Host considered stale after this
 static const int MAX_FRAME_DRIFT = 5;            // Frames drift before flagging
+static const int DEFAULT_CLOCK_PROBE_INTERVAL = 2; // Seconds between clock probes when enabled
+static const char* PLUGIN_CONFIG_FILE = "/home/fpp/media/config/plugin.fpp-plugin-watcher";
 
 // Issue types
 enum class IssueType {
@@ -73,6 +79,8 @@ public:
         // Load any persisted state
         LoadState();
 
+        StartClockProbe();
+
         m_enabled = true;
         LogInfo(VB_PLUGIN, "WatcherMultiSync: Plugin initialized successfully\n");
     }
@@ -80,6 +88,7 @@ public:
     virtual ~WatcherMultiSyncPlugin() {
         LogInfo(VB_PLUGIN, "WatcherMultiSync: Shutting down\n");
         MultiSync::INSTANCE.removeMultiSyncPlugin(this);
+        m_clockProbe->Stop();
         SaveState();
     }
 
@@ -345,6 +354,8 @@ public:
             result = GetActiveIssues();
         } else if (path == "/fpp-plugin-watcher/multisync/status") {
             result = GetStatus();
+        } else if (path == "/fpp-plugin-watcher/multisync/clock") {
+            result = GetClockOffsets();
         } else {
             result["error"] = "Unknown endpoint";
             std::string json = SaveJsonToString(result);
@@ -385,6 +396,7 @@ public:
         ws->register_resource("/fpp-plugin-watcher/multisync/metrics", this);
         ws->register_resource("/fpp-plugin-watcher/multisync/issues", this);
         ws->register_resource("/fpp-plugin-watcher/multisync/status", this);
+        ws->register_resource("/fpp-plugin-watcher/multisync/clock", this);
         ws->register_resource("/fpp-plugin-watcher/multisync/reset", this);
     }
 
@@ -393,6 +405,7 @@ public:
         ws->unregister_resource("/fpp-plugin-watcher/multisync/metrics");
         ws->unregister_resource("/fpp-plugin-watcher/multisync/issues");
         ws->unregister_resource("/fpp-plugin-watcher/multisync/status");
+        ws->unregister_resource("/fpp-plugin-watcher/multisync/clock");
         ws->unregister_resource("/fpp-plugin-watcher/multisync/reset");
     }
 
@@ -574,6 +587,95 @@ private:
         LogInfo(VB_PLUGIN, "WatcherMultiSync: Metrics reset\n");
     }
 
+    Json::Value GetClockOffsets() {
+        Json::Value result = m_clockProbe->GetResults();
+        if (!m_clockProbeEnabled) {
+            result["error"] = "Clock probe disabled (clockProbeEnabled is off)";
+        }
+        return result;
+    }
+
+    // Plugin config is INI-style: key = "value"
+    std::map<std::string, std::string> ReadPluginConfig() {
+        std::map<std::string, std::string> config;
+        std::ifstream in(PLUGIN_CONFIG_FILE);
+        std::string line;
+        while (std::getline(in, line)) {
+            size_t eq = line.find('=');
+            if (eq == std::string::npos) continue;
+            std::string key = TrimConfigToken(line.substr(0, eq));
+            std::string value = TrimConfigToken(line.substr(eq + 1));
+            if (!key.empty()) {
+                config[key] = value;
+            }
+        }
+        return config;
+    }
+
+    static std::string TrimConfigToken(const std::string& token) {
+        size_t start = token.find_first_not_of(" \t\r\"");
+        if (start == std::string::npos) return "";
+        size_t end = token.find_last_not_of(" \t\r\"");
+        return token.substr(start, end - start + 1);
+    }
+
+    void StartClockProbe() {
+        auto config = ReadPluginConfig();
+
+        // Opt-in like the other multi-sync network features
+        m_clockProbeEnabled = (config["clockProbeEnabled"] == "true" || config["clockProbeEnabled"] == "1");
+
+        int intervalSec = DEFAULT_CLOCK_PROBE_INTERVAL;
+        if (config.count("clockProbeInterval")) {
+            intervalSec = std::max(1, std::min(60, atoi(config["clockProbeInterval"].c_str())));
+        }
+        int port = WatcherClockProbe::DEFAULT_PORT;
+        if (config.count("clockProbePort") && atoi(config["clockProbePort"].c_str()) > 0) {
+            port = atoi(config["clockProbePort"].c_str());
+        }
+
+        // Extra numeric "ip[:port]" targets, e.g. 127.0.0.1:32330 to probe a second local instance
+        std::vector<ClockProbeTarget> extraTargets;
+        std::stringstream ss(config["clockProbeTargets"]);
+        std::string entry;
+        while (std::getline(ss, entry, ',')) {
+            entry = TrimConfigToken(entry);
+            if (entry.empty()) continue;
+            ClockProbeTarget target;
+            size_t colon = entry.find(':');
+            target.address = entry.substr(0, colon);
+            target.hostname = target.address;
+            if (colon != std::string::npos) {
+                target.port = atoi(entry.substr(colon + 1).c_str());
+            }
+            extraTargets.push_back(target);
+        }
+
+        m_clockProbe.reset(new WatcherClockProbe(port, intervalSec * 1000,
+            [extraTargets]() {
+                std::vector<ClockProbeTarget> targets = extraTargets;
+                Json::Value systems = MultiSync::INSTANCE.GetSystems(false, false)["systems"];
+                for (const auto& system : systems) {
+                    // Skip ourselves and non-FPP devices (controllers report typeId >= 0x80)
+                    if (system.get("local", false).asBool()) continue;
+                    if (system.get("typeId", 1).asInt() >= 0x80) continue;
+                    ClockProbeTarget target;
+                    target.address = system.get("address", "").asString();
+                    target.hostname = system.get("hostname", "").asString();
+                    if (!target.address.empty()) {
+                        targets.push_back(target);
+                    }
+                }
+                return targets;
+            }));
+
+        // The object always exists so /multisync/clock has one response shape;
+        // when disabled nothing is bound and no probes are sent
+        if (m_clockProbeEnabled) {
+            m_clockProbe->Start();
+        }
+    }
+
     void CreateDirectoryIfMissing(const std::string& path) {
         struct stat st;
         if (stat(path.c_str(), &st) != 0) {
@@ -661,6 +763,10 @@ private:
     double m_syncIntervalJitterMs = 0.0;   // RFC 3550 jitter: variation in sync packet arrival times
     int m_syncIntervalSamples = 0;
     bool m_hasPreviousSyncTime = false;
+
+    // NTP-style UDP clock offset probe (answers peers, probes remotes)
+    std::unique_ptr<WatcherClockProbe> m_clockProbe;
+    bool m_clockProbeEnabled = false;
 };
 
 // Plugin entry point
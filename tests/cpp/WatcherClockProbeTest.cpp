@@ -0,0 +1,208 @@
+/*
+ * WatcherClockProbeTest.cpp - Tests for the UDP clock offset probe
+ *
+ * Covers the pure four-timestamp math and clock filter, then runs two
+ * probe instances against each other over loopback. Build and run with
+ * `make -C tests/cpp`.
+ */
+
+#include <arpa/inet.h>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "WatcherClockProbe.h"
+
+static int s_failures = 0;
+static int s_checks = 0;
+
+#define CHECK(cond) do { \
+    s_checks++; \
+    if (!(cond)) { \
+        s_failures++; \
+        std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #cond << std::endl; \
+    } \
+} while (0)
+
+#define CHECK_NEAR(a, b, tol) CHECK(std::fabs((double)(a) - (double)(b)) <= (tol))
+
+// Loopback ports well away from FPP MultiSync (32320) and the default (32329)
+static const int PORT_A = 32340;
+static const int PORT_B = 32341;
+
+static void TestOffsetSignRemoteAhead() {
+    // Symmetric 1ms path, remote clock 5ms ahead, remote holds 200us
+    ClockSample s;
+    int64_t t1 = 1000000;
+    int64_t t2 = t1 + 1000 + 5000;
+    int64_t t3 = t2 + 200;
+    CHECK(ComputeClockSample(t1, 0, t2, t3, 2200, s));
+    CHECK_NEAR(s.offsetUs, 5000, 0.001);
+    CHECK_NEAR(s.rttUs, 2000, 0.001);
+    CHECK(s.atMonoUs == 2200);
+}
+
+static void TestOffsetSignRemoteBehind() {
+    ClockSample s;
+    int64_t t1 = 1000000;
+    int64_t t2 = t1 + 500 - 3000;
+    int64_t t3 = t2;
+    CHECK(ComputeClockSample(t1, 100, t2, t3, 1100, s));
+    CHECK_NEAR(s.offsetUs, -3000, 0.001);
+    CHECK_NEAR(s.rttUs, 1000, 0.001);
+}
+
+static void TestAsymmetricPathErrorIsHalfTheAsymmetry() {
+    // 300us out, 700us back, clocks equal: error is (300 - 700) / 2
+    ClockSample s;
+    int64_t t1 = 0;
+    CHECK(ComputeClockSample(t1, 0, 300, 300, 1000, s));
+    CHECK_NEAR(s.offsetUs, -200, 0.001);
+    CHECK_NEAR(s.rttUs, 1000, 0.001);
+}
+
+static void TestRttUsesMonotonicClockOnly() {
+    // t4 is derived from t1 plus monotonic elapsed, so shifting every realtime
+    // stamp by the same amount (a step before send) changes nothing
+    ClockSample a, b;
+    CHECK(ComputeClockSample(1000, 50, 1600, 1700, 1250, a));
+    CHECK(ComputeClockSample(1000 + 3600000000LL, 50, 1600 + 3600000000LL, 1700 + 3600000000LL, 1250, b));
+    CHECK_NEAR(a.offsetUs, b.offsetUs, 0.001);
+    CHECK_NEAR(a.rttUs, b.rttUs, 0.001);
+}
+
+static void TestRejectsImpossibleExchanges() {
+    ClockSample s;
+    // Received before sent
+    CHECK(!ComputeClockSample(0, 1000, 0, 0, 900, s));
+    // Remote transmit before receive
+    CHECK(!ComputeClockSample(0, 0, 500, 400, 1000, s));
+    // Remote hold longer than the whole round trip
+    CHECK(!ComputeClockSample(0, 0, 0, 2000, 1000, s));
+}
+
+static void TestSequenceAcceptance() {
+    // Probes 1..4 sent (next is 5), 2 already accepted
+    CHECK(IsExpectedSequence(3, 2, 5));
+    CHECK(IsExpectedSequence(4, 2, 5));
+    CHECK(!IsExpectedSequence(2, 2, 5));   // duplicate
+    CHECK(!IsExpectedSequence(1, 2, 5));   // out of order
+    CHECK(!IsExpectedSequence(5, 2, 5));   // never sent
+    CHECK(!IsExpectedSequence(0, 0, 1));   // nothing sent yet
+}
+
+static void TestFilterSelectsMinRtt() {
+    std::deque<ClockSample> samples;
+    CHECK(SelectMinRttSample(samples) == 0);
+    CHECK(ClockFilterJitterUs(samples, 0) == 0.0);
+
+    ClockSample s;
+    s.offsetUs = 900; s.rttUs = 4000; samples.push_back(s);
+    s.offsetUs = 120; s.rttUs = 350;  samples.push_back(s);
+    s.offsetUs = -60; s.rttUs = 2000; samples.push_back(s);
+    s.offsetUs = 130; s.rttUs = 350;  samples.push_back(s);
+
+    // Ties keep the earliest sample
+    size_t best = SelectMinRttSample(samples);
+    CHECK(best == 1);
+    CHECK_NEAR(samples[best].offsetUs, 120, 0.001);
+
+    // sqrt((780^2 + 0 + 180^2 + 10^2) / 3)
+    double expected = std::sqrt((780.0 * 780.0 + 180.0 * 180.0 + 10.0 * 10.0) / 3.0);
+    CHECK_NEAR(ClockFilterJitterUs(samples, best), expected, 0.001);
+}
+
+static void TestJitterSingleSample() {
+    std::deque<ClockSample> samples(1);
+    CHECK(SelectMinRttSample(samples) == 0);
+    CHECK(ClockFilterJitterUs(samples, 0) == 0.0);
+}
+
+static void TestResultsShapeWhenNotStarted() {
+    WatcherClockProbe probe(PORT_A, 1000, nullptr);
+    Json::Value r = probe.GetResults();
+    CHECK(r["running"].asBool() == false);
+    CHECK(r.isMember("error"));
+    CHECK(r["port"].asInt() == PORT_A);
+    CHECK(r["intervalMs"].asInt() == 1000);
+    CHECK(r["filterSize"].asInt() == WatcherClockProbe::FILTER_SIZE);
+    CHECK(r.isMember("requestsServed"));
+    CHECK(r.isMember("invalidPackets"));
+    CHECK(r["hosts"].isArray());
+    CHECK(r["count"].asInt() == 0);
+}
+
+static void TestLoopbackBetweenInstances() {
+    // A probes B every 100ms; B only answers. Hostnames are rejected (numeric only).
+    WatcherClockProbe a(PORT_A, 100, []() {
+        std::vector<ClockProbeTarget> targets;
+        targets.push_back({ "127.0.0.1", "b", PORT_B });
+        targets.push_back({ "localhost", "skipped", PORT_B });
+        return targets;
+    });
+    WatcherClockProbe b(PORT_B, 0, nullptr);
+    CHECK(b.Start());
+    CHECK(a.Start());
+
+    // A second instance on B's port must fail loudly instead of sharing it
+    WatcherClockProbe clash(PORT_B, 0, nullptr);
+    CHECK(!clash.Start());
+    Json::Value clashResults = clash.GetResults();
+    CHECK(clashResults["running"].asBool() == false);
+    CHECK(clashResults["error"].asString().find("bind failed on port " + std::to_string(PORT_B)) == 0);
+
+    // A response-type packet from an address A never probed is counted as invalid
+    int raw = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in dest;
+    memset(&dest, 0, sizeof(dest));
+    dest.sin_family = AF_INET;
+    dest.sin_port = htons(PORT_A);
+    inet_pton(AF_INET, "127.0.0.1", &dest.sin_addr);
+    uint8_t bogus[48] = { 'W', 'C', 'L', 'K', 1, 2 };
+    sendto(raw, bogus, sizeof(bogus), 0, (sockaddr*)&dest, sizeof(dest));
+    close(raw);
+
+    usleep(1500 * 1000);
+
+    Json::Value ra = a.GetResults();
+    Json::Value rb = b.GetResults();
+    a.Stop();
+    b.Stop();
+
+    CHECK(ra["running"].asBool());
+    CHECK(!ra.isMember("error"));
+    CHECK(ra["count"].asInt() == 1);
+    CHECK(ra["invalidPackets"].asUInt64() >= 1);
+
+    const Json::Value& host = ra["hosts"][0];
+    CHECK(host["address"].asString() == "127.0.0.1");
+    CHECK(host["port"].asInt() == PORT_B);
+    CHECK(host["hasData"].asBool());
+    CHECK(host["samples"].asInt() == WatcherClockProbe::FILTER_SIZE);
+    CHECK(host["responsesReceived"].asUInt64() > 0);
+    // Same clock on both ends: offset and RTT well under a millisecond
+    CHECK(std::fabs(host["offsetMs"].asDouble()) < 1.0);
+    CHECK(host["rttMs"].asDouble() >= 0.0 && host["rttMs"].asDouble() < 1.0);
+
+    CHECK(rb["requestsServed"].asUInt64() >= host["responsesReceived"].asUInt64());
+    CHECK(rb["count"].asInt() == 0);
+}
+
+int main() {
+    TestOffsetSignRemoteAhead();
+    TestOffsetSignRemoteBehind();
+    TestAsymmetricPathErrorIsHalfTheAsymmetry();
+    TestRttUsesMonotonicClockOnly();
+    TestRejectsImpossibleExchanges();
+    TestSequenceAcceptance();
+    TestFilterSelectsMinRtt();
+    TestJitterSingleSample();
+    TestResultsShapeWhenNotStarted();
+    TestLoopbackBetweenInstances();
+
+    std::cout << (s_checks - s_failures) << "/" << s_checks << " checks passed" << std::endl;
+    return s_failures == 0 ? 0 : 1;
+}
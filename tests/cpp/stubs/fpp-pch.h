@@ -0,0 +1,2 @@
+// Stand-in for FPP's precompiled header when building tests outside FPP
+#pragma once
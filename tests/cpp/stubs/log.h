@@ -0,0 +1,9 @@
+// Stand-in for FPP's log.h when building tests outside FPP
+#pragma once
+
+#include <cstdio>
+
+#define VB_PLUGIN 0
+#define LogErr(facility, ...) fprintf(stderr, __VA_ARGS__)
+#define LogInfo(facility, ...) ((void)0)
+#define LogDebug(facility, ...) ((void)0)
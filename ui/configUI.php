@@ -44,6 +44,8 @@ if ($_SERVER['REQUEST_METHOD'] === 'POST' && isset($_POST['save_settings'])) {
     $multiSyncMetricsEnabled = isset($_POST['multiSyncMetricsEnabled']) ? 'true' : 'false';
     $multiSyncPingEnabled = isset($_POST['multiSyncPingEnabled']) ? 'true' : 'false';
     $multiSyncPingInterval = intval($_POST['multiSyncPingInterval'] ?? 60);
+    $clockProbeEnabled = isset($_POST['clockProbeEnabled']) ? 'true' : 'false';
+    $clockProbeInterval = intval($_POST['clockProbeInterval'] ?? 2);
     $falconMonitorEnabled = isset($_POST['falconMonitorEnabled']) ? 'true' : 'false';
     $controlUIEnabled = isset($_POST['controlUIEnabled']) ? 'true' : 'false';
     $mqttMonitorEnabled = isset($_POST['mqttMonitorEnabled']) ? 'true' : 'false';
@@ -92,6 +94,9 @@ if ($_SERVER['REQUEST_METHOD'] === 'POST' && isset($_POST['save_settings'])) {
     if ($multiSyncPingInterval < 10 || $multiSyncPingInterval > 300) {
         $errors[] = "Multi-sync ping interval must be between 10 and 300 seconds";
     }
+    if ($clockProbeInterval < 1 || $clockProbeInterval > 60) {
+        $errors[] = "Clock probe interval must be between 1 and 60 seconds";
+    }
     if ($mqttRetentionDays < 1 || $mqttRetentionDays > 365) {
         $errors[] = "MQTT retention must be between 1 and 365 days";
     }
@@ -120,6 +125,8 @@ if ($_SERVER['REQUEST_METHOD'] === 'POST' && isset($_POST['save_settings'])) {
             'multiSyncMetricsEnabled' => $multiSyncMetricsEnabled,
             'multiSyncPingEnabled' => $multiSyncPingEnabled,
             'multiSyncPingInterval' => $multiSyncPingInterval,
+            'clockProbeEnabled' => $clockProbeEnabled,
+            'clockProbeInterval' => $clockProbeInterval,
             'falconMonitorEnabled' => $falconMonitorEnabled,
             'controlUIEnabled' => $controlUIEnabled,
             'mqttMonitorEnabled' => $mqttMonitorEnabled,
@@ -498,6 +505,35 @@ window.watcherConfig = {
             </div>
             <?php endif; ?>
 
+            <!-- Clock Probe Panel -->
+            <div class="settingsPanel">
+                <div class="panelHeader" onclick="page.watcherTogglePanel(this)">
+                    <div class="panelTitle">
+                        <label class="toggleSwitch toggleSwitch--sm" onclick="event.stopPropagation()">
+                            <input type="checkbox" id="clockProbeEnabled" name="clockProbeEnabled" value="1"
+                                <?php echo (!empty($config['clockProbeEnabled'])) ? 'checked' : ''; ?>>
+                            <span class="toggleSlider toggleSlider--green"></span>
+                        </label>
+                        <i class="fas fa-clock"></i>
+                        Clock Probe
+                    </div>
+                    <i class="fas fa-chevron-down panelToggle"></i>
+                </div>
+                <div class="panelBody">
+                    <div class="panelDesc" style="margin-bottom: 1rem;">
+                        Measure clock offset and round-trip time to multi-sync remotes with UDP timestamp probes (port <?php echo htmlspecialchars((string)($config['clockProbePort'] ?? WATCHERDEFAULTSETTINGS['clockProbePort'])); ?>).
+                        Enable on the player and every remote that should answer. Requires FPPD restart.
+                    </div>
+                    <div class="formRow">
+                        <div class="formGroup">
+                            <label class="formLabel">Probe Interval (sec)</label>
+                            <input type="number" id="clockProbeInterval" name="clockProbeInterval" class="form-control"
+                                min="1" max="60" value="<?php echo htmlspecialchars((string)($config['clockProbeInterval'] ?? WATCHERDEFAULTSETTINGS['clockProbeInterval'])); ?>">
+                        </div>
+                    </div>
+                </div>
+            </div>
+
             <!-- Falcon Controller Monitor Panel -->
             <div class="settingsPanel">
                 <div class="panelHeader" onclick="page.watcherTogglePanel(this)">